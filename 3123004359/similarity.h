@@ -0,0 +1,80 @@
+#pragma once
+#include <cstdint>    // ׼ͣuint32_t
+#include <vector>     // ̬
+#include <algorithm>  // 㷨max
+
+/**
+ * UTF-8ֽתΪUnicode
+ * @param bytes UTF-8ֽ
+ * @return Unicode飨ÿԪΪ4ֽ㣩
+ */
+inline std::vector<uint32_t> utf8_to_codepoints(const std::vector<unsigned char>& bytes) {
+    std::vector<uint32_t> codepoints;
+    size_t i = 0;
+    while (i < bytes.size()) {
+        unsigned char byte = bytes[i];
+        // 1ַֽASCII
+        if (byte <= 0x7F) {
+            codepoints.push_back(byte);
+            i += 1;
+        }
+        // 2ַֽĸչ
+        else if ((byte & 0xE0) == 0xC0) {
+            if (i + 1 >= bytes.size()) break; // ַ
+            uint32_t cp = ((byte & 0x1F) << 6) | (bytes[i + 1] & 0x3F);
+            codepoints.push_back(cp);
+            i += 2;
+        }
+        // 3ַֽ糣ú֣
+        else if ((byte & 0xF0) == 0xE0) {
+            if (i + 2 >= bytes.size()) break;
+            uint32_t cp = ((byte & 0x0F) << 12) | ((bytes[i + 1] & 0x3F) << 6) | (bytes[i + 2] & 0x3F);
+            codepoints.push_back(cp);
+            i += 3;
+        }
+        // 4ַֽƧֻţ
+        else if ((byte & 0xF8) == 0xF0) {
+            if (i + 3 >= bytes.size()) break;
+            uint32_t cp = ((byte & 0x07) << 18) | ((bytes[i + 1] & 0x3F) << 12) | ((bytes[i + 2] & 0x3F) << 6) | (bytes[i + 3] & 0x3F);
+            codepoints.push_back(cp);
+            i += 4;
+        }
+        // Чֽڴ
+        else {
+            i += 1;
+        }
+    }
+    return codepoints;
+}
+
+/**
+ * еУLCS
+ * @param s1 1
+ * @param s2 2
+ * @return LCSȣŻռ临ӶO(min(m,n))
+ */
+inline int lcs(const std::vector<uint32_t>& s1, const std::vector<uint32_t>& s2) {
+    int m = s1.size();
+    int n = s2.size();
+    if (m == 0 || n == 0) return 0;
+
+    // ȷs2ǽ϶УŻռʹ
+    if (m < n) return lcs(s2, s1);
+
+    // ʹùŻռ
+    std::vector<int> dp(n + 1, 0);
+    for (int i = 1; i <= m; ++i) {
+        int prev = 0; // Ͻǵֵ
+        for (int j = 1; j <= n; ++j) {
+            int temp = dp[j];
+            if (s1[i - 1] == s2[j - 1]) {
+                dp[j] = prev + 1; // ַƥ䣬+1
+            }
+            else {
+                dp[j] = std::max(dp[j], dp[j - 1]); // ȡϷֵ
+            }
+            prev = temp; // Ͻֵ
+        }
+    }
+    return dp[n]; // һԪ
+}
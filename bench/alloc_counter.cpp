@@ -0,0 +1,36 @@
+#include <cstdlib>  // malloc/free
+#include <new>      // operator new/delete
+#include "alloc_counter.h"
+
+bool g_counting = false;
+std::size_t g_allocs = 0;
+std::size_t g_alloc_bytes = 0;
+
+//  new ʽ֤ͷ·һ
+static void* allocate(std::size_t size) noexcept {
+    if (g_counting) {
+        ++g_allocs;
+        g_alloc_bytes += size;
+    }
+    return std::malloc(size ? size : 1);
+}
+
+void* operator new(std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    if (void* p = allocate(size)) return p;
+    throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return allocate(size); }
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
@@ -0,0 +1,8 @@
+#pragma once
+#include <cstddef>  // size_t
+
+// ȫ operator new/delete 滻 alloc_counter.cpp У
+// ɱⱻô׼ķ·һ
+extern bool g_counting;            // ΪʱͳƷ
+extern std::size_t g_allocs;       // ۼƷ
+extern std::size_t g_alloc_bytes;  // ۼƷֽ
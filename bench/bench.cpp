@@ -0,0 +1,790 @@
+#include <cstdint>     // ׼
+#include <cctype>      // isspace
+#include <cmath>       // abs
+#include <cstdlib>     // exit/strtod
+#include <cstring>     // strlen
+#include <chrono>      // ʱ
+#include <fstream>     // ļд
+#include <iomanip>     // ʽ
+#include <iostream>    // 
+#include <map>         // 
+#include <memory>      // unique_ptr
+#include <random>      // ɸֵα
+#include <sstream>     // ַ
+#include <string>      // ַ
+#include <vector>      // ̬
+#include <algorithm>   // min/max
+#include <stdexcept>   // runtime_error
+
+#include "alloc_counter.h" // ѷ
+#include "similarity.h"  // Ĳأutf8_to_codepoints / lcs
+#include "fraction.h"    // 㣺Fraction
+#include "generator.h"   // 㣺ProblemGenerator
+#include "evaluator.h"   // 㣺ExpressionEvaluator
+
+// ֹѻ׼еļŻ
+template <class T>
+inline void keep(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "g"(&value) : "memory");
+#else
+    static const void* volatile sink;
+    sink = &value;
+#endif
+}
+
+// ===================== в =====================
+
+struct Options {
+    unsigned seed = 20240901;  // 
+    int reps = 5;              // ÿ׼ظȡһΣ
+    double minTime = 0.1;      // ΢׼ÿظʱ룩
+    bool full = false;         // Ƿģϣ1M/10M еȣ
+    std::string filter;        // ֻưӴĻ׼
+    std::string jsonFile;      //  JSON ߵ·
+    std::string compareFile;   // Աȵ JSON ·
+    double tolerance = 0.10;   // ĺʱ˱
+};
+
+void printHelp() {
+    std::cout << "Usage: bench [options]\n"
+        << "  --seed N         corpus seed (default 20240901)\n"
+        << "  --reps N         repetitions per benchmark, fastest is reported (default 5)\n"
+        << "  --min-time SEC   minimum time per repetition for micro benchmarks (default 0.1)\n"
+        << "  --full           include large corpora (1M/10M-line banks, 64k LCS)\n"
+        << "  --filter STR     only run benchmarks whose name contains STR\n"
+        << "  --json FILE      write results as a JSON baseline\n"
+        << "  --compare FILE   compare against a JSON baseline, exit 1 on regression\n"
+        << "  --tolerance F    allowed slowdown ratio for --compare (default 0.10)\n"
+        << "  -h, --help       show this help\n";
+}
+
+Options parseArguments(int argc, char* argv[]) {
+    Options opt;
+    std::vector<std::string> args(argv + 1, argv + argc);
+
+    for (size_t i = 0; i < args.size(); ++i) {
+        const std::string& arg = args[i];
+        auto value = [&]() -> const std::string& {
+            if (++i >= args.size()) throw std::runtime_error("missing value for " + arg);
+            return args[i];
+        };
+
+        if (arg == "-h" || arg == "--help") {
+            printHelp();
+            std::exit(0);
+        }
+        else if (arg == "--seed") opt.seed = static_cast<unsigned>(std::stoul(value()));
+        else if (arg == "--reps") opt.reps = std::stoi(value());
+        else if (arg == "--min-time") opt.minTime = std::stod(value());
+        else if (arg == "--full") opt.full = true;
+        else if (arg == "--filter") opt.filter = value();
+        else if (arg == "--json") opt.jsonFile = value();
+        else if (arg == "--compare") opt.compareFile = value();
+        else if (arg == "--tolerance") opt.tolerance = std::stod(value());
+        else throw std::runtime_error("unknown option: " + arg);
+    }
+
+    if (opt.reps < 1) throw std::runtime_error("--reps must be >= 1");
+    if (opt.minTime <= 0) throw std::runtime_error("--min-time must be > 0");
+    if (opt.tolerance < 0) throw std::runtime_error("--tolerance must be >= 0");
+    return opt;
+}
+
+// ===================== ʱ =====================
+
+struct Result {
+    std::string name;
+    std::string unit;          // ļλcodepointscellslines ȣ
+    std::size_t iterations;    // ÿظִеĲ
+    double nsPerOp;            // ÿβʱ룬ظһΣܸС
+    double itemsPerOp;         // ÿβĵλ
+    double allocsPerOp;        // ÿβĶѷ
+    double bytesPerOp;         // ÿβĶѷֽ
+    double failuresPerOp;      // ׳쳣Ĳռȣʱ·
+
+    double opsPerSec() const { return nsPerOp > 0 ? 1e9 / nsPerOp : 0; }
+    double itemsPerSec() const { return opsPerSec() * itemsPerOp; }
+};
+
+class Runner {
+    const Options& opt;
+    std::vector<Result> results;
+    std::size_t failures = 0;  // ͨ fail() ʧܴ
+
+    using Clock = std::chrono::steady_clock;
+
+    // ִһظܺʱ룩ʧܴۼӵ allocs/bytes/fails
+    template <class Setup, class Op>
+    double runOnce(std::size_t n, Setup& setup, Op& op,
+        std::size_t& allocs, std::size_t& bytes, std::size_t& fails) {
+        setup();
+        std::size_t f0 = failures;
+        std::size_t a0 = g_allocs, b0 = g_alloc_bytes;
+        g_counting = true;
+        auto start = Clock::now();
+        for (std::size_t i = 0; i < n; ++i) op(i);
+        auto stop = Clock::now();
+        g_counting = false;
+        allocs += g_allocs - a0;
+        bytes += g_alloc_bytes - b0;
+        fails += failures - f0;
+        return std::chrono::duration<double, std::nano>(stop - start).count();
+    }
+
+public:
+    explicit Runner(const Options& o) : opt(o) {}
+
+    bool enabled(const std::string& name) const {
+        return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+    }
+
+    // ʧܣ׳쳣ʱã failuresPerOp
+    void fail() { ++failures; }
+
+    /**
+     * һ׼
+     * @param name ׼ƣڹ߶Աȣ
+     * @param unit λ
+     * @param itemsPerOp ÿβĵλ
+     * @param iterations ÿظĲΪ0ʱԶ궨 --min-time
+     * @param setup ÿظǰִУʱ
+     * @param op Ϊ
+     */
+    template <class Setup, class Op>
+    void measure(const std::string& name, const std::string& unit, double itemsPerOp,
+        std::size_t iterations, Setup setup, Op op) {
+        if (!enabled(name)) return;
+
+        std::size_t allocs = 0, bytes = 0, fails = 0;
+
+        // 궨Ϸֱظﵽʱ
+        std::size_t n = iterations;
+        if (n == 0) {
+            n = 1;
+            while (true) {
+                std::size_t a = 0, b = 0, f = 0;
+                double ns = runOnce(n, setup, op, a, b, f);
+                if (ns >= opt.minTime * 1e9 || n >= (std::size_t(1) << 30)) break;
+                double scale = ns > 0 ? opt.minTime * 1e9 / ns * 1.2 : 10.0;
+                n = static_cast<std::size_t>(n * std::min(std::max(scale, 2.0), 10.0));
+            }
+        }
+        else {
+            std::size_t a = 0, b = 0, f = 0;
+            runOnce(n, setup, op, a, b, f);  // Ԥ
+        }
+
+        double best = 0;
+        for (int r = 0; r < opt.reps; ++r) {
+            double ns = runOnce(n, setup, op, allocs, bytes, fails) / n;
+            if (r == 0 || ns < best) best = ns;
+        }
+
+        double total = static_cast<double>(n) * opt.reps;
+        Result res{ name, unit, n, best, itemsPerOp,
+            allocs / total, bytes / total, fails / total };
+        results.push_back(res);
+        print(res);
+    }
+
+    template <class Op>
+    void measure(const std::string& name, const std::string& unit, double itemsPerOp,
+        std::size_t iterations, Op op) {
+        measure(name, unit, itemsPerOp, iterations, [] {}, op);
+    }
+
+    const std::vector<Result>& all() const { return results; }
+
+    static void printHeader() {
+        std::cout << std::left << std::setw(36) << "benchmark"
+            << std::right << std::setw(14) << "ns/op"
+            << std::setw(14) << "ops/s"
+            << std::setw(22) << "throughput"
+            << std::setw(12) << "allocs/op"
+            << std::setw(14) << "bytes/op"
+            << std::setw(10) << "failed" << '\n';
+    }
+
+    static void print(const Result& r) {
+        std::ostringstream tp;
+        double ips = r.itemsPerSec();
+        const char* prefix = "";
+        if (ips >= 1e9) { ips /= 1e9; prefix = "G"; }
+        else if (ips >= 1e6) { ips /= 1e6; prefix = "M"; }
+        else if (ips >= 1e3) { ips /= 1e3; prefix = "k"; }
+        tp << std::fixed << std::setprecision(2) << ips << ' ' << prefix << r.unit << "/s";
+
+        std::cout << std::left << std::setw(36) << r.name << std::right
+            << std::fixed << std::setprecision(1) << std::setw(14) << r.nsPerOp
+            << std::setprecision(0) << std::setw(14) << r.opsPerSec()
+            << std::setw(22) << tp.str()
+            << std::setprecision(2) << std::setw(12) << r.allocsPerOp
+            << std::setprecision(0) << std::setw(14) << r.bytesPerOp
+            << std::setprecision(2) << std::setw(9) << r.failuresPerOp * 100 << "%\n";
+    }
+};
+
+// ===================== ϳ =====================
+
+enum class Script { CJK, ASCII };
+
+const char* scriptName(Script s) { return s == Script::CJK ? "cjk" : "ascii"; }
+
+// ָȵУԳúΪȫǱ㣬ӢΪ
+std::vector<uint32_t> makeText(Script script, std::size_t length, std::mt19937& gen) {
+    std::vector<uint32_t> text;
+    text.reserve(length);
+    std::uniform_real_distribution<> p(0.0, 1.0);
+
+    if (script == Script::CJK) {
+        static const uint32_t punct[] = { 0xFF0C, 0x3002, 0x3001, 0xFF1B, 0xFF1A, 0x201C, 0x201D, 0xFF01, 0xFF1F };
+        std::uniform_int_distribution<uint32_t> han(0x4E00, 0x9FA5);
+        std::uniform_int_distribution<int> pick(0, sizeof(punct) / sizeof(punct[0]) - 1);
+        std::uniform_int_distribution<uint32_t> ascii('0', 'z');
+        while (text.size() < length) {
+            double x = p(gen);
+            if (x < 0.85) text.push_back(han(gen));
+            else if (x < 0.95) text.push_back(punct[pick(gen)]);
+            else text.push_back(ascii(gen));
+        }
+    }
+    else {
+        std::uniform_int_distribution<uint32_t> letter('a', 'z');
+        std::uniform_int_distribution<int> wordLen(1, 10);
+        while (text.size() < length) {
+            for (int k = wordLen(gen); k > 0 && text.size() < length; --k) {
+                text.push_back(letter(gen));
+            }
+            if (text.size() < length) {
+                double x = p(gen);
+                text.push_back(x < 0.05 ? '\n' : x < 0.12 ? ',' : x < 0.17 ? '.' : ' ');
+            }
+        }
+    }
+    return text;
+}
+
+// ģⳭϮɾ滻ַ
+std::vector<uint32_t> plagiarize(const std::vector<uint32_t>& original, Script script,
+    double rate, std::mt19937& gen) {
+    std::vector<uint32_t> pool = makeText(script, 1024, gen);
+    std::uniform_real_distribution<> p(0.0, 1.0);
+    std::uniform_int_distribution<std::size_t> pick(0, pool.size() - 1);
+
+    std::vector<uint32_t> copy;
+    copy.reserve(original.size() + original.size() / 8);
+    for (uint32_t cp : original) {
+        double x = p(gen);
+        if (x >= rate) copy.push_back(cp);
+        else if (x < rate / 3) continue;  // ɾ
+        else if (x < rate * 2 / 3) copy.push_back(pool[pick(gen)]);  // 滻
+        else {  // 
+            copy.push_back(pool[pick(gen)]);
+            copy.push_back(cp);
+        }
+    }
+    return copy;
+}
+
+std::vector<unsigned char> encodeUtf8(const std::vector<uint32_t>& text) {
+    std::vector<unsigned char> bytes;
+    bytes.reserve(text.size() * 3);
+    for (uint32_t cp : text) {
+        if (cp <= 0x7F) {
+            bytes.push_back(static_cast<unsigned char>(cp));
+        }
+        else if (cp <= 0x7FF) {
+            bytes.push_back(static_cast<unsigned char>(0xC0 | (cp >> 6)));
+            bytes.push_back(static_cast<unsigned char>(0x80 | (cp & 0x3F)));
+        }
+        else if (cp <= 0xFFFF) {
+            bytes.push_back(static_cast<unsigned char>(0xE0 | (cp >> 12)));
+            bytes.push_back(static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3F)));
+            bytes.push_back(static_cast<unsigned char>(0x80 | (cp & 0x3F)));
+        }
+        else {
+            bytes.push_back(static_cast<unsigned char>(0xF0 | (cp >> 18)));
+            bytes.push_back(static_cast<unsigned char>(0x80 | ((cp >> 12) & 0x3F)));
+            bytes.push_back(static_cast<unsigned char>(0x80 | ((cp >> 6) & 0x3F)));
+            bytes.push_back(static_cast<unsigned char>(0x80 | (cp & 0x3F)));
+        }
+    }
+    return bytes;
+}
+
+// ⣺ generateProblems ͬķʽɻظĿȥ " = " ׺
+std::vector<std::string> makeBank(std::size_t count, int range, unsigned seed) {
+    ProblemGenerator generator(range, seed);
+    std::vector<std::string> bank;
+    bank.reserve(count);
+    while (bank.size() < count) {
+        bank.push_back(generator.generate()->toString());
+    }
+    return bank;
+}
+
+std::string sizeLabel(std::size_t n) {
+    if (n >= 1000000 && n % 1000000 == 0) return std::to_string(n / 1000000) + "M";
+    if (n >= 1000 && n % 1000 == 0) return std::to_string(n / 1000) + "k";
+    return std::to_string(n);
+}
+
+// ===================== ׼Ŀ =====================
+
+// ֵ׼ʹõֵΧ-rΧСʱȥؼϺܿľ޷ɰĿ
+constexpr int kRange = 20;
+
+void benchFraction(Runner& runner, const Options& opt) {
+    // Ԥɵķأڼʱڲ
+    constexpr std::size_t kPool = 4096;
+    std::mt19937 gen(opt.seed);
+    std::uniform_int_distribution<> num(1, 99), den(1, 19);
+    std::vector<Fraction> pool;
+    std::vector<std::string> text;
+    for (std::size_t i = 0; i < kPool; ++i) {
+        pool.emplace_back(num(gen), den(gen));
+        text.push_back(pool.back().toString());
+    }
+    auto at = [&](std::size_t i) -> const Fraction& { return pool[i & (kPool - 1)]; };
+
+    runner.measure("fraction/add", "ops", 1, 0,
+        [&](std::size_t i) { keep(at(i) + at(i + 1)); });
+    runner.measure("fraction/sub", "ops", 1, 0,
+        [&](std::size_t i) { keep(at(i) - at(i + 1)); });
+    runner.measure("fraction/mul", "ops", 1, 0,
+        [&](std::size_t i) { keep(at(i) * at(i + 1)); });
+    runner.measure("fraction/div", "ops", 1, 0,
+        [&](std::size_t i) { keep(at(i) / at(i + 1)); });
+    runner.measure("fraction/less", "ops", 1, 0,
+        [&](std::size_t i) { bool b = at(i) < at(i + 1); keep(b); });
+    runner.measure("fraction/parse", "ops", 1, 0,
+        [&](std::size_t i) { keep(Fraction::parse(text[i & (kPool - 1)])); });
+    runner.measure("fraction/to_string", "ops", 1, 0,
+        [&](std::size_t i) { keep(at(i).toString()); });
+}
+
+void benchUtf8(Runner& runner, const Options& opt) {
+    std::vector<std::size_t> sizes = { 1000, 10000, 100000, 1000000 };
+    for (Script script : { Script::CJK, Script::ASCII }) {
+        for (std::size_t n : sizes) {
+            std::string name = std::string("utf8_to_codepoints/") + scriptName(script) + "/" + sizeLabel(n);
+            if (!runner.enabled(name)) continue;
+            std::mt19937 gen(opt.seed ^ static_cast<unsigned>(n));
+            auto bytes = encodeUtf8(makeText(script, n, gen));
+            runner.measure(name, "codepoints", static_cast<double>(n), 0,
+                [&](std::size_t) { keep(utf8_to_codepoints(bytes)); });
+        }
+    }
+}
+
+void benchLcs(Runner& runner, const Options& opt) {
+    // LCS Ϊ O(m*n)1M ı޷ںʱɣ˹ģ޵ڽ׼
+    std::vector<std::size_t> sizes = { 1000, 4000, 16000 };
+    if (opt.full) sizes.push_back(64000);
+    for (Script script : { Script::CJK, Script::ASCII }) {
+        for (std::size_t n : sizes) {
+            std::string name = std::string("lcs/") + scriptName(script) + "/" + sizeLabel(n);
+            if (!runner.enabled(name)) continue;
+            std::mt19937 gen(opt.seed ^ static_cast<unsigned>(n * 31));
+            auto original = makeText(script, n, gen);
+            auto copy = plagiarize(original, script, 0.15, gen);
+            double cells = static_cast<double>(original.size()) * copy.size();
+            runner.measure(name, "cells", cells, n >= 16000 ? 1 : 0,
+                [&](std::size_t) { keep(lcs(original, copy)); });
+        }
+    }
+}
+
+void benchGenerate(Runner& runner, const Options& opt) {
+    std::vector<std::size_t> sizes = { 1000, 10000, 100000 };
+    if (opt.full) sizes.push_back(1000000);
+    for (std::size_t n : sizes) {
+        std::string name = "generate/" + sizeLabel(n);
+        // ÿظʹͬһӵ֤ȥؼϴӿտʼ
+        //  generateProblems һ£ʧܵĿʧܴ
+        std::unique_ptr<ProblemGenerator> generator;
+        runner.measure(name, "problems", 1, n,
+            [&] { generator.reset(); generator = std::make_unique<ProblemGenerator>(kRange, opt.seed); },
+            [&](std::size_t) {
+                try {
+                    keep(generator->generate());
+                }
+                catch (const std::exception&) {
+                    runner.fail();
+                }
+            });
+    }
+}
+
+void benchEvaluate(Runner& runner, const Options& opt) {
+    // ⳬ kPool ʱѭͬһظĿڴռñֲ
+    constexpr std::size_t kPool = 100000;
+    std::vector<std::size_t> sizes = { 1000, 10000, 100000 };
+    if (opt.full) {
+        sizes.push_back(1000000);
+        sizes.push_back(10000000);
+    }
+
+    std::vector<std::string> bank;
+    for (std::size_t n : sizes) {
+        std::string name = "evaluate/" + sizeLabel(n);
+        if (!runner.enabled(name)) continue;
+        if (bank.empty()) bank = makeBank(kPool, kRange, opt.seed);
+        std::size_t distinct = std::min(n, kPool);
+        //  checkAnswers һ£ֵʧܵаж֣
+        // ⱣԭԷӳʵָأʧռȵ
+        runner.measure(name, "lines", 1, n,
+            [&](std::size_t i) {
+                try {
+                    keep(ExpressionEvaluator::evaluate(bank[i % distinct]));
+                }
+                catch (const std::exception&) {
+                    runner.fail();
+                }
+            });
+    }
+}
+
+// ===================== ߶д =====================
+
+std::string jsonEscape(const std::string& s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+// ÿ׼ռһУ diff 鿴
+void writeBaseline(const std::string& path, const Options& opt, const std::vector<Result>& results) {
+    std::ofstream out(path);
+    if (!out) throw std::runtime_error("cannot open " + path);
+
+    out << "{\n";
+    out << "  \"schema\": 2,\n";
+    out << "  \"seed\": " << opt.seed << ",\n";
+    out << "  \"reps\": " << opt.reps << ",\n";
+    out << "  \"full\": " << (opt.full ? "true" : "false") << ",\n";
+#if defined(__VERSION__)
+    out << "  \"compiler\": \"" << jsonEscape(__VERSION__) << "\",\n";
+#endif
+    out << "  \"benchmarks\": [\n";
+    out << std::setprecision(17);
+    for (size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        out << "    {\"name\": \"" << jsonEscape(r.name) << "\""
+            << ", \"unit\": \"" << jsonEscape(r.unit) << "\""
+            << ", \"iterations\": " << r.iterations
+            << ", \"ns_per_op\": " << r.nsPerOp
+            << ", \"ops_per_sec\": " << r.opsPerSec()
+            << ", \"items_per_sec\": " << r.itemsPerSec()
+            << ", \"allocs_per_op\": " << r.allocsPerOp
+            << ", \"bytes_per_op\": " << r.bytesPerOp
+            << ", \"failures_per_op\": " << r.failuresPerOp << "}"
+            << (i + 1 < results.size() ? "," : "") << '\n';
+    }
+    out << "  ]\n}\n";
+}
+
+// ļ JSON ֵֻҪ顢ַ벼ֵ
+struct JsonValue {
+    enum Type { Null, Bool, Number, String, Array, Object } type = Null;
+    bool boolean = false;
+    double number = 0;
+    std::string text;
+    std::vector<JsonValue> items;
+    std::map<std::string, JsonValue> members;
+
+    const JsonValue& at(const std::string& key) const {
+        auto it = members.find(key);
+        if (type != Object || it == members.end()) throw std::runtime_error("baseline: missing \"" + key + "\"");
+        return it->second;
+    }
+    double asNumber() const {
+        if (type != Number) throw std::runtime_error("baseline: expected a number");
+        return number;
+    }
+};
+
+// ݹ½ʽޣɶȡдĻļ
+class JsonParser {
+    const std::string& src;
+    size_t pos = 0;
+
+    [[noreturn]] void fail(const std::string& what) const {
+        throw std::runtime_error("baseline: " + what + " at offset " + std::to_string(pos));
+    }
+
+    void skipSpace() {
+        while (pos < src.size() && std::isspace(static_cast<unsigned char>(src[pos]))) ++pos;
+    }
+
+    bool consume(char c) {
+        skipSpace();
+        if (pos < src.size() && src[pos] == c) {
+            ++pos;
+            return true;
+        }
+        return false;
+    }
+
+    void expect(char c) {
+        if (!consume(c)) fail(std::string("expected '") + c + "'");
+    }
+
+    bool literal(const char* word) {
+        size_t len = std::strlen(word);
+        if (src.compare(pos, len, word) != 0) return false;
+        pos += len;
+        return true;
+    }
+
+    std::string parseString() {
+        expect('"');
+        std::string out;
+        while (pos < src.size() && src[pos] != '"') {
+            char c = src[pos++];
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos >= src.size()) break;
+            char e = src[pos++];
+            switch (e) {
+            case '"': case '\\': case '/': out += e; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                // ԲҪ֧֣еƾΪ ASCII
+                if (pos + 4 > src.size()) fail("truncated \\u escape");
+                uint32_t cp = static_cast<uint32_t>(std::stoul(src.substr(pos, 4), nullptr, 16));
+                pos += 4;
+                if (cp <= 0x7F) out += static_cast<char>(cp);
+                else if (cp <= 0x7FF) {
+                    out += static_cast<char>(0xC0 | (cp >> 6));
+                    out += static_cast<char>(0x80 | (cp & 0x3F));
+                }
+                else {
+                    out += static_cast<char>(0xE0 | (cp >> 12));
+                    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+                    out += static_cast<char>(0x80 | (cp & 0x3F));
+                }
+                break;
+            }
+            default: fail("invalid escape");
+            }
+        }
+        if (pos >= src.size()) fail("unterminated string");
+        ++pos;
+        return out;
+    }
+
+    JsonValue parseValue() {
+        skipSpace();
+        if (pos >= src.size()) fail("unexpected end of input");
+
+        JsonValue v;
+        char c = src[pos];
+        if (c == '{') {
+            ++pos;
+            v.type = JsonValue::Object;
+            if (consume('}')) return v;
+            do {
+                skipSpace();
+                std::string key = parseString();
+                expect(':');
+                v.members[key] = parseValue();
+            } while (consume(','));
+            expect('}');
+        }
+        else if (c == '[') {
+            ++pos;
+            v.type = JsonValue::Array;
+            if (consume(']')) return v;
+            do {
+                v.items.push_back(parseValue());
+            } while (consume(','));
+            expect(']');
+        }
+        else if (c == '"') {
+            v.type = JsonValue::String;
+            v.text = parseString();
+        }
+        else if (literal("true")) {
+            v.type = JsonValue::Bool;
+            v.boolean = true;
+        }
+        else if (literal("false")) {
+            v.type = JsonValue::Bool;
+        }
+        else if (literal("null")) {
+            v.type = JsonValue::Null;
+        }
+        else {
+            const char* begin = src.c_str() + pos;
+            char* end = nullptr;
+            v.type = JsonValue::Number;
+            v.number = std::strtod(begin, &end);
+            if (end == begin) fail("unexpected character");
+            pos += end - begin;
+        }
+        return v;
+    }
+
+public:
+    explicit JsonParser(const std::string& text) : src(text) {}
+
+    JsonValue parse() {
+        JsonValue v = parseValue();
+        skipSpace();
+        if (pos != src.size()) fail("trailing characters");
+        return v;
+    }
+};
+
+struct Baseline {
+    unsigned seed = 0;
+    bool full = false;
+    std::map<std::string, Result> results;
+};
+
+Baseline readBaseline(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) throw std::runtime_error("cannot open baseline " + path);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+
+    JsonValue root = JsonParser(buffer.str()).parse();
+    const JsonValue& full = root.at("full");
+    const JsonValue& list = root.at("benchmarks");
+    if (full.type != JsonValue::Bool || list.type != JsonValue::Array) {
+        throw std::runtime_error("baseline: malformed \"full\" or \"benchmarks\"");
+    }
+
+    Baseline baseline;
+    baseline.seed = static_cast<unsigned>(root.at("seed").asNumber());
+    baseline.full = full.boolean;
+    for (const JsonValue& entry : list.items) {
+        const JsonValue& name = entry.at("name");
+        if (name.type != JsonValue::String) throw std::runtime_error("baseline: \"name\" must be a string");
+        Result r{ name.text, "", 0, entry.at("ns_per_op").asNumber(), 0,
+            entry.at("allocs_per_op").asNumber(), entry.at("bytes_per_op").asNumber(),
+            entry.at("failures_per_op").asNumber() };
+        baseline.results[r.name] = r;
+    }
+    if (baseline.results.empty()) throw std::runtime_error("no benchmarks in baseline " + path);
+    return baseline;
+}
+
+/**
+ * ߶Ա
+ * @return ڻʱ falseʱݲÿβķӡʧռȱ仯
+ *         еĻ׼δУûκλ׼ɹԱ
+ */
+bool compareBaseline(const std::string& path, const Baseline& baseline, const Runner& runner,
+    const Options& opt) {
+    bool ok = true;
+    std::size_t compared = 0;
+
+    std::cout << "\ncomparing against " << path << " (tolerance "
+        << std::fixed << std::setprecision(1) << opt.tolerance * 100 << "%)\n";
+    for (const Result& r : runner.all()) {
+        auto it = baseline.results.find(r.name);
+        if (it == baseline.results.end()) {
+            std::cout << "  new        " << r.name << '\n';
+            continue;
+        }
+        ++compared;
+        const Result& b = it->second;
+        double ratio = b.nsPerOp > 0 ? r.nsPerOp / b.nsPerOp : 1.0;
+        bool slower = ratio > 1.0 + opt.tolerance;
+        bool moreAllocs = r.allocsPerOp > b.allocsPerOp + std::max(0.01, b.allocsPerOp * 0.01);
+        // ͬʧܵĲȫȷκα仯˵Ϊ
+        bool failuresChanged = std::abs(r.failuresPerOp - b.failuresPerOp) > 1e-9;
+        bool regressed = slower || moreAllocs || failuresChanged;
+
+        const char* status = regressed ? "REGRESSED" : ratio < 1.0 - opt.tolerance ? "improved" : "ok";
+        std::cout << "  " << std::left << std::setw(11) << status << std::setw(36) << r.name << std::right
+            << std::setprecision(2) << std::setw(8) << ratio << "x time";
+        if (moreAllocs) {
+            std::cout << ", allocs/op " << b.allocsPerOp << " -> " << r.allocsPerOp;
+        }
+        if (failuresChanged) {
+            std::cout << ", failed " << b.failuresPerOp * 100 << "% -> " << r.failuresPerOp * 100 << '%';
+        }
+        std::cout << '\n';
+        if (regressed) ok = false;
+    }
+
+    // СΰӦȴûнĻ׼ɾΪ
+    for (const auto& entry : baseline.results) {
+        if (!runner.enabled(entry.first)) continue;
+        bool ran = false;
+        for (const Result& r : runner.all()) {
+            if (r.name == entry.first) {
+                ran = true;
+                break;
+            }
+        }
+        if (!ran) {
+            std::cout << "  MISSING    " << entry.first << '\n';
+            ok = false;
+        }
+    }
+
+    if (compared == 0) {
+        std::cout << "  no benchmarks matched the baseline\n";
+        ok = false;
+    }
+    return ok;
+}
+
+int main(int argc, char* argv[]) {
+    try {
+        Options opt = parseArguments(argc, argv);
+        Runner runner(opt);
+
+        // ȶȡߣӻϹģͬĽɱȣֱӾܾ
+        Baseline baseline;
+        if (!opt.compareFile.empty()) {
+            baseline = readBaseline(opt.compareFile);
+            if (baseline.seed != opt.seed) {
+                throw std::runtime_error("baseline was recorded with --seed " + std::to_string(baseline.seed)
+                    + ", this run uses " + std::to_string(opt.seed));
+            }
+            if (baseline.full != opt.full) {
+                throw std::runtime_error(std::string("baseline was recorded ") + (baseline.full ? "with" : "without")
+                    + " --full, this run " + (opt.full ? "uses" : "does not use") + " it");
+            }
+        }
+
+        std::cout << "seed " << opt.seed << ", reps " << opt.reps
+            << (opt.full ? ", full corpora" : "") << "\n\n";
+        Runner::printHeader();
+
+        benchFraction(runner, opt);
+        benchUtf8(runner, opt);
+        benchLcs(runner, opt);
+        benchGenerate(runner, opt);
+        benchEvaluate(runner, opt);
+
+        if (!opt.jsonFile.empty()) {
+            writeBaseline(opt.jsonFile, opt, runner.all());
+            std::cout << "\nbaseline written to " << opt.jsonFile << '\n';
+        }
+        if (!opt.compareFile.empty() && !compareBaseline(opt.compareFile, baseline, runner, opt)) {
+            return 1;
+        }
+    }
+    catch (const std::exception& e) {
+        std::cerr << "error: " << e.what() << std::endl;
+        printHelp();
+        return 2;
+    }
+    return 0;
+}
@@ -12,13 +12,13 @@ class ProblemGenerator {
 
     std::unique_ptr<Expression> generateNumber() {
         std::uniform_int_distribution<> num_dist(0, max_range - 1);
-        std::uniform_int_distribution<> den_dist(1, max_range - 1);
 
-        if (std::bernoulli_distribution(0.5)(gen)) {
+        // ΧΪ1ʱĸΪգֻȻ
+        if (max_range < 2 || std::bernoulli_distribution(0.5)(gen)) {
             return std::make_unique<Number>(num_dist(gen));
         }
         else {
-            int den = den_dist(gen);
+            int den = std::uniform_int_distribution<>(1, max_range - 1)(gen);
             int num = std::uniform_int_distribution<>(0, den * (max_range - 1) - 1)(gen);
             return std::make_unique<Number>(num, den);
         }
@@ -35,6 +35,8 @@ class ProblemGenerator {
             int left_ops = std::uniform_int_distribution<>(0, ops_left - 1)(gen);
             auto left = generateExpression(left_ops);
             auto right = generateExpression(ops_left - 1 - left_ops);
+            // ӱʽ޷ȥʱֱʧܣԺľʱ
+            if (!left || !right) return nullptr;
 
             // ֤
             if (op == '-' && left->evaluate() < right->evaluate()) continue;